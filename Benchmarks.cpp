@@ -0,0 +1,723 @@
+// =====================================================================================
+//
+//       Filename:  Benchmarks.cpp
+//
+//    Description:  Driver program for micro-benchmarks of Boxes, PF_Column and PF_Chart
+//
+//        Version:  1.0
+//        Created:  2026-10-18 09:30 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (dpr), driedel@cox.net
+//        License:  GNU General Public License v3
+//        Company:
+//
+// =====================================================================================
+
+/* This file is part of Point and Figure. */
+
+/* Extractor_Markup is free software: you can redistribute it and/or modify */
+/* it under the terms of the GNU General Public License as published by */
+/* the Free Software Foundation, either version 3 of the License, or */
+/* (at your option) any later version. */
+
+/* Extractor_Markup is distributed in the hope that it will be useful, */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the */
+/* GNU General Public License for more details. */
+
+/* You should have received a copy of the GNU General Public License */
+/* along with Extractor_Markup.  If not, see <http://www.gnu.org/licenses/>. */
+
+// =====================================================================================
+//        Class:
+//  Description:  run with --benchmark_out=<file> --benchmark_out_format=json
+//                (or 'make -f makefile_bench run') to keep results for comparison.
+// =====================================================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <new>
+#include <ranges>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+namespace rng = std::ranges;
+namespace vws = std::ranges::views;
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <decimal.hh>
+
+using decimal::Decimal;
+
+using namespace std::literals::chrono_literals;
+using namespace std::string_literals;
+namespace fs = std::filesystem;
+
+#include "Boxes.h"
+#include "PF_Chart.h"
+#include "PF_Column.h"
+#include "utilities.h"
+
+// count every global allocation so benchmarks can report allocations per
+// iteration alongside their timings. This is how we check changes meant to
+// cut down on the many small allocations made while building charts.
+// over-aligned allocations are counted too. The nothrow forms call these so
+// they don't need their own replacements.
+
+std::atomic<int64_t> g_allocation_count{0};
+
+void *operator new(std::size_t size)
+{
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    // aligned_alloc wants the size to be a multiple of the alignment
+
+    const auto align = static_cast<std::size_t>(alignment);
+    const auto rounded_size = ((size == 0 ? 1 : size) + align - 1) / align * align;
+    if (void *p = std::aligned_alloc(align, rounded_size))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void *p, std::align_val_t /* alignment */) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t /* alignment */) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t /* size */, std::align_val_t /* alignment */) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t /* size */, std::align_val_t /* alignment */) noexcept
+{
+    std::free(p);
+}
+
+void ReportAllocations(benchmark::State &state, int64_t allocations_at_start)
+{
+    const auto allocations = g_allocation_count.load(std::memory_order_relaxed) - allocations_at_start;
+    state.counters["allocs_per_iter"] =
+        benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+// NOLINTBEGIN(*-magic-numbers)
+
+// the same 'first set of test data' the unit tests use
+
+const std::vector<int32_t> kFirstSetOfTestData = {
+    1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129, 1120, 1139, 1121, 1129, 1138, 1113, 1139, 1123,
+    1128, 1136, 1111, 1095, 1102, 1108, 1092, 1129, 1122, 1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127,
+    1138, 1111, 1122, 1111, 1128, 1115, 1117, 1120, 1119, 1132, 1133, 1147, 1131, 1159, 1136, 1127};
+
+const fs::path kSPYStreamingCSV{"./test_files/SPY_streaming_1min_2022-10-07.csv"};
+const fs::path kAAPLCloseCSV{"./test_files/AAPL_close.dat"};
+
+// some utility code for generating test data (same as in Unit_Test.cpp)
+
+std::string MakeSimpleTestData(const std::vector<int32_t> &data, const std::chrono::year_month_day &first_day)
+{
+    // make some business days (although, not doing holidays)
+    auto holidays = MakeHolidayList(first_day.year());
+    rng::copy(MakeHolidayList(++(first_day.year())), std::back_inserter(holidays));
+    const auto dates = ConstructeBusinessDayList(first_day, rng::size(data), UpOrDown::e_Up, &holidays);
+
+    auto test_values = vws::zip(dates, data);
+
+    std::string test_data;
+
+    for (const auto &[date, value] : test_values)
+    {
+        test_data.append(std::format("{},{}\n", date, value));
+    }
+    return test_data;
+}
+
+std::optional<int> FindColumnIndex(std::string_view header, std::string_view column_name, std::string_view delim)
+{
+    auto fields = rng_split_string<std::string_view>(header, delim);
+    auto do_compare([&column_name](const auto &field_name) {
+        if (column_name.size() != field_name.size())
+        {
+            return false;
+        }
+        return rng::equal(column_name, field_name,
+                          [](unsigned char a, unsigned char b) { return tolower(a) == tolower(b); });
+    });
+
+    if (auto found_it = rng::find_if(fields, do_compare); found_it != rng::end(fields))
+    {
+        return rng::distance(rng::begin(fields), found_it);
+    }
+    return {};
+}
+
+// load the SPY 1 minute streaming data once and share it between benchmarks.
+// parsing is done here so it doesn't get counted in the timings.
+
+struct StreamedPrice
+{
+    PF_Column::TmPt tp_;
+    Decimal price_;
+};
+
+const std::vector<StreamedPrice> &SPYStreamingPrices()
+{
+    static const std::vector<StreamedPrice> prices = [] {
+        const std::string file_content_csv = LoadDataFileForUse(kSPYStreamingCSV);
+
+        const auto symbol_data_records = split_string<std::string_view>(file_content_csv, "\n");
+        const auto header_record = symbol_data_records.front();
+
+        auto date_column = FindColumnIndex(header_record, "date", ",");
+        BOOST_ASSERT_MSG(date_column.has_value(),
+                         std::format("Can't find 'date' field in header record: {}.", header_record).c_str());
+
+        auto close_column = FindColumnIndex(header_record, "close", ",");
+        BOOST_ASSERT_MSG(close_column.has_value(),
+                         std::format("Can't find price field: 'Close' in header record: {}.", header_record).c_str());
+
+        std::vector<StreamedPrice> result;
+        for (const auto record : symbol_data_records | vws::drop(1))
+        {
+            if (record.empty())
+            {
+                continue;
+            }
+            const auto fields = split_string<std::string_view>(record, ",");
+            result.emplace_back(StreamedPrice{.tp_ = StringToUTCTimePoint("%F %X%z", fields[date_column.value()]),
+                                              .price_ = sv2dec(fields[close_column.value()])});
+        }
+        return result;
+    }();
+    return prices;
+}
+
+const std::vector<Decimal> &SPYStreamingCloses()
+{
+    static const std::vector<Decimal> closes =
+        SPYStreamingPrices() | vws::transform([](const auto &p) { return p.price_; }) | rng::to<std::vector>();
+    return closes;
+}
+
+PF_Chart MakeSPYStreamingChart()
+{
+    PF_Chart chart{"SPY", Decimal(".01"), 3};
+    rng::for_each(SPYStreamingPrices(), [&chart](const auto &p) { chart.AddValue(p.price_, p.tp_); });
+    return chart;
+}
+
+// =====================================================================================
+//  Boxes
+// =====================================================================================
+
+void BM_BoxesFindBoxLinear(benchmark::State &state)
+{
+    // each FindBox benchmark builds its ladder once to cover the price range and
+    // times only the lookups. BM_BoxesFindBoxFarJump times ladder growth.
+
+    const auto prices =
+        kFirstSetOfTestData | vws::transform([](auto x) { return Decimal{x}; }) | rng::to<std::vector>();
+    Boxes boxes{Decimal{10}};
+    rng::for_each(prices, [&boxes](const auto &price) { boxes.FindBox(price); });
+
+    for (auto _ : state)
+    {
+        for (const auto &price : prices)
+        {
+            benchmark::DoNotOptimize(boxes.FindBox(price));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+}
+BENCHMARK(BM_BoxesFindBoxLinear);
+
+void BM_BoxesFindBoxFractional(benchmark::State &state)
+{
+    const auto &prices = SPYStreamingCloses();
+    Boxes boxes{Decimal(".01")};
+    rng::for_each(prices, [&boxes](const auto &price) { boxes.FindBox(price); });
+
+    for (auto _ : state)
+    {
+        for (const auto &price : prices)
+        {
+            benchmark::DoNotOptimize(boxes.FindBox(price));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+}
+BENCHMARK(BM_BoxesFindBoxFractional);
+
+void BM_BoxesFindBoxPercent(benchmark::State &state)
+{
+    const auto &prices = SPYStreamingCloses();
+    Boxes boxes{Decimal{10}, Decimal(".01"), BoxScale::e_Percent};
+    rng::for_each(prices, [&boxes](const auto &price) { boxes.FindBox(price); });
+
+    for (auto _ : state)
+    {
+        for (const auto &price : prices)
+        {
+            benchmark::DoNotOptimize(boxes.FindBox(price));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+}
+BENCHMARK(BM_BoxesFindBoxPercent);
+
+// a far jump is the case where the ladder has to grow a lot in one call
+
+void BM_BoxesFindBoxFarJump(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        Boxes boxes{Decimal(".01")};
+        benchmark::DoNotOptimize(boxes.FindBox(Decimal("100.00")));
+        benchmark::DoNotOptimize(boxes.FindBox(Decimal(state.range(0))));
+    }
+}
+BENCHMARK(BM_BoxesFindBoxFarJump)->Arg(110)->Arg(200)->Arg(1000);
+
+// Arg: 0 - integer linear boxes, 1 - fractional linear boxes, 2 - percent boxes
+
+void BM_BoxesFindNextAndPrevBox(benchmark::State &state)
+{
+    // a ladder which already covers the price range so we time only the lookups
+
+    const auto integer_prices =
+        kFirstSetOfTestData | vws::transform([](auto x) { return Decimal{x}; }) | rng::to<std::vector>();
+
+    const auto scale = state.range(0);
+    const auto &prices = scale == 0 ? integer_prices : SPYStreamingCloses();
+    Boxes boxes = [scale] {
+        switch (scale)
+        {
+            case 0:
+                return Boxes{Decimal{10}};
+            case 1:
+                return Boxes{Decimal(".01")};
+            default:
+                return Boxes{Decimal{10}, Decimal(".01"), BoxScale::e_Percent};
+        }
+    }();
+    rng::for_each(prices, [&boxes](const auto &price) { boxes.FindBox(price); });
+    const auto some_boxes = prices | vws::transform([&boxes](const auto &price) { return boxes.FindBox(price); }) |
+                            rng::to<std::vector>();
+
+    for (auto _ : state)
+    {
+        for (const auto &box : some_boxes)
+        {
+            benchmark::DoNotOptimize(boxes.FindNextBox(box));
+            benchmark::DoNotOptimize(boxes.FindPrevBox(box));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(some_boxes.size()) * 2);
+}
+BENCHMARK(BM_BoxesFindNextAndPrevBox)->Arg(0)->Arg(1)->Arg(2);
+
+// the second pass over the history we make now to count price hits per box
+
+void BM_BoxesCountHitsByReplay(benchmark::State &state)
+{
+    const auto &prices = SPYStreamingCloses();
+
+    for (auto _ : state)
+    {
+        Boxes boxes{Decimal(".01")};
+        std::map<Boxes::Box, int32_t> hits;
+        for (const auto &price : prices)
+        {
+            ++hits[boxes.FindBox(price)];
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+}
+BENCHMARK(BM_BoxesCountHitsByReplay);
+
+// =====================================================================================
+//  PF_Column
+// =====================================================================================
+
+void BM_ColumnAddValue(benchmark::State &state)
+{
+    const auto &prices = SPYStreamingPrices();
+    const auto reversal = static_cast<int32_t>(state.range(0));
+    int64_t ignored = 0;
+
+    for (auto _ : state)
+    {
+        Boxes boxes{Decimal(".01")};
+        PF_Column col{&boxes, 0, reversal};
+
+        ignored = 0;
+        for (const auto &[tp, price] : prices)
+        {
+            auto [status, new_col] = col.AddValue(price, tp);
+            if (status == PF_Column::Status::e_Ignored)
+            {
+                ++ignored;
+            }
+            else if (status == PF_Column::Status::e_Reversal)
+            {
+                col = std::move(new_col.value());
+                col.AddValue(price, tp);
+            }
+        }
+        benchmark::DoNotOptimize(col);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+
+    // most streamed ticks neither extend nor reverse the column so this is the
+    // share of the work a no-op fast path can save.
+
+    state.counters["ignored_pct"] = 100.0 * static_cast<double>(ignored) / static_cast<double>(prices.size());
+}
+BENCHMARK(BM_ColumnAddValue)->Arg(1)->Arg(2)->Arg(3)->Arg(5);
+
+// =====================================================================================
+//  PF_Chart
+// =====================================================================================
+
+void BM_ChartAddValue(benchmark::State &state)
+{
+    const auto &prices = SPYStreamingPrices();
+    const auto reversal = static_cast<int32_t>(state.range(0));
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        PF_Chart chart{"SPY", Decimal(".01"), reversal};
+        for (const auto &[tp, price] : prices)
+        {
+            benchmark::DoNotOptimize(chart.AddValue(price, tp));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartAddValue)->Arg(1)->Arg(3);
+
+// signal detection runs on every accepted value. Report how many signals
+// per second come out of the SPY 1 minute data at .01 x 3 along with the
+// rate of values processed.
+
+void BM_ChartSignals(benchmark::State &state)
+{
+    const auto &prices = SPYStreamingPrices();
+
+    int64_t signals_found{0};
+    int64_t values_with_signal{0};
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        PF_Chart chart{"SPY", Decimal(".01"), 3};
+        for (const auto &[tp, price] : prices)
+        {
+            if (chart.AddValue(price, tp) == PF_Column::Status::e_AcceptedWithSignal)
+            {
+                ++values_with_signal;
+            }
+        }
+        signals_found += static_cast<int64_t>(chart.GetSignals().size());
+        benchmark::DoNotOptimize(chart);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(prices.size()));
+    ReportAllocations(state, allocations_at_start);
+    state.counters["signals_per_sec"] =
+        benchmark::Counter(static_cast<double>(signals_found), benchmark::Counter::kIsRate);
+    state.counters["signals"] =
+        benchmark::Counter(static_cast<double>(signals_found), benchmark::Counter::kAvgIterations);
+    state.counters["values_with_signal"] =
+        benchmark::Counter(static_cast<double>(values_with_signal), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ChartSignals);
+
+void BM_ChartToJSON(benchmark::State &state)
+{
+    const PF_Chart chart = MakeSPYStreamingChart();
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(chart.ToJSON());
+    }
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartToJSON);
+
+// what it costs a rendering thread to take its own copy of a streaming chart
+
+void BM_ChartSnapshot(benchmark::State &state)
+{
+    const PF_Chart chart = MakeSPYStreamingChart();
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        PF_Chart snapshot = chart;
+        benchmark::DoNotOptimize(snapshot);
+    }
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartSnapshot);
+
+void BM_ChartWriteJSONToStream(benchmark::State &state)
+{
+    const PF_Chart chart = MakeSPYStreamingChart();
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        std::ostringstream chart_text;
+        chart.ConvertChartToJsonAndWriteToStream(chart_text);
+        benchmark::DoNotOptimize(chart_text);
+    }
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartWriteJSONToStream);
+
+// the table export formats every column as text. bytes/second is the number
+// to compare any other export format against.
+
+void BM_ChartWriteTableToStream(benchmark::State &state)
+{
+    PF_Chart chart = MakeSPYStreamingChart();
+
+    int64_t bytes_written{0};
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        std::ostringstream table_text;
+        chart.ConvertChartToTableAndWriteToStream(table_text);
+        bytes_written += static_cast<int64_t>(table_text.view().size());
+        benchmark::DoNotOptimize(table_text);
+    }
+    ReportAllocations(state, allocations_at_start);
+    state.SetBytesProcessed(bytes_written);
+    state.counters["columns"] = static_cast<double>(chart.size());
+}
+BENCHMARK(BM_ChartWriteTableToStream);
+
+// box enumeration for every column is what graphics construction does
+
+void BM_ChartGetColumnBoxes(benchmark::State &state)
+{
+    const PF_Chart chart = MakeSPYStreamingChart();
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        std::size_t total = 0;
+        for (const auto &col : chart)
+        {
+            total += rng::size(col.GetColumnBoxes());
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chart.size()));
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartGetColumnBoxes);
+
+void BM_ChartColumnFilters(benchmark::State &state)
+{
+    const PF_Chart chart = MakeSPYStreamingChart();
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        for (const auto filter : {PF_ColumnFilter::e_up_column, PF_ColumnFilter::e_down_column,
+                                  PF_ColumnFilter::e_reversed_to_up, PF_ColumnFilter::e_reversed_to_down})
+        {
+            benchmark::DoNotOptimize(chart.GetBoxesForColumns(filter));
+            benchmark::DoNotOptimize(chart.GetTopBottomForColumns(filter));
+        }
+    }
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartColumnFilters);
+
+void BM_ChartFromJSON(benchmark::State &state)
+{
+    const auto json = MakeSPYStreamingChart().ToJSON();
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        PF_Chart chart{json};
+        benchmark::DoNotOptimize(chart);
+    }
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartFromJSON);
+
+// loading a stored chart file is what a daily scan does for every symbol
+
+void BM_ChartLoadFromJSONFile(benchmark::State &state)
+{
+    const fs::path chart_file_name{"/tmp/Benchmarks_SPY_chart.json"};
+    {
+        std::ofstream chart_file{chart_file_name, std::ios::out | std::ios::binary | std::ios::trunc};
+        MakeSPYStreamingChart().ConvertChartToJsonAndWriteToStream(chart_file);
+    }
+    const auto file_size = static_cast<int64_t>(fs::file_size(chart_file_name));
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        PF_Chart chart;
+        PF_Chart::LoadChartFromJSONPF_ChartFile(chart, chart_file_name);
+        benchmark::DoNotOptimize(chart);
+    }
+    state.SetBytesProcessed(state.iterations() * file_size);
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartLoadFromJSONFile);
+
+void BM_ChartBuildFromCSVStreamSimpleData(benchmark::State &state)
+{
+    const std::string test_data = MakeSimpleTestData(
+        kFirstSetOfTestData, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]});
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        std::istringstream prices{test_data};
+        PF_Chart chart("GOOG", 10, 2);
+        chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+        benchmark::DoNotOptimize(chart);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kFirstSetOfTestData.size()));
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartBuildFromCSVStreamSimpleData);
+
+void BM_ChartBuildFromCSVStreamFile(benchmark::State &state)
+{
+    const std::string test_data = LoadDataFileForUse(kAAPLCloseCSV);
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        std::istringstream prices{test_data};
+        PF_Chart chart("AAPL", 2, 2);
+        chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+        benchmark::DoNotOptimize(chart);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(test_data.size()));
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartBuildFromCSVStreamFile);
+
+// one symbol's worth of a bulk load: build the chart, serialize it, throw it away
+
+void BM_ChartBuildSerializeAndDestroy(benchmark::State &state)
+{
+    const std::string test_data = LoadDataFileForUse(kAAPLCloseCSV);
+
+    const auto allocations_at_start = g_allocation_count.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        std::istringstream prices{test_data};
+        PF_Chart chart("AAPL", 2, 2);
+        chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+        std::ostringstream chart_json;
+        chart.ConvertChartToJsonAndWriteToStream(chart_json);
+        benchmark::DoNotOptimize(chart_json);
+    }
+    ReportAllocations(state, allocations_at_start);
+}
+BENCHMARK(BM_ChartBuildSerializeAndDestroy);
+
+// NOLINTEND(*-magic-numbers)
+
+int main(int argc, char **argv)
+{
+    // keep the library quiet while we are timing it
+
+    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+    auto bench_logger = std::make_shared<spdlog::logger>("Bench_logger", // Name for the console logger
+                                                         console_sink);
+
+    spdlog::set_default_logger(bench_logger);
+    spdlog::set_level(spdlog::level::err);
+
+    // same decimal setup as the test drivers so the numbers are comparable
+
+    decimal::context_template = decimal::IEEEContext(decimal::DECIMAL64);
+    decimal::context_template.round(decimal::ROUND_HALF_EVEN);
+    decimal::context = decimal::context_template;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
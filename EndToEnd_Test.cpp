@@ -26,6 +26,7 @@
 #include <format>
 #include <fstream>
 #include <future>
+#include <map>
 #include <print>
 #include <ranges>
 
@@ -773,6 +774,115 @@ TEST_F(SingleFileEndToEnd, VerifyCanConstructChartFileFromPieces) // NOLINT
     ASSERT_TRUE(whole_chart == franken_chart);
 }
 
+// run the program with the given options and return the charts it built keyed by chart file name
+
+std::map<std::string, PF_Chart> RunAndCollectCharts(const std::vector<std::string> &tokens)
+{
+    std::map<std::string, PF_Chart> charts;
+    try
+    {
+        PF_CollectDataApp myApp(tokens);
+
+        bool startup_OK = myApp.Startup();
+        if (startup_OK)
+        {
+            myApp.Run();
+            for (const auto &a_chart : myApp.GetCharts())
+            {
+                charts.emplace(a_chart.second.MakeChartFileName("eod", "json"), a_chart.second);
+            }
+            myApp.Shutdown();
+        }
+        else
+        {
+            std::cout << "Problems starting program.  No processing done.\n";
+        }
+    }
+
+    // catch any problems trying to setup application
+
+    catch (const std::exception &theProblem)
+    {
+        spdlog::error(std::format("Something fundamental went wrong: {}", theProblem.what()));
+    }
+    catch (...)
+    { // handle exception: unspecified
+        spdlog::error("Something totally unexpected happened.");
+    }
+    return charts;
+}
+
+TEST_F(SingleFileEndToEnd, VerifyMultipleBoxsizesAndReversalsMatchSingleRuns) // NOLINT
+{
+    // each chart from a run with several box sizes and reversals is the same as the
+    // chart from a run with just that box size and reversal.
+
+    if (fs::exists("/tmp/test_charts_fanout"))
+    {
+        fs::remove_all("/tmp/test_charts_fanout");
+    }
+
+    const auto *test_info = UnitTest::GetInstance()->current_test_info();
+    spdlog::info(std::format("\n\nTest: {}  test case: {} \n\n", test_info->name(), test_info->test_suite_name()));
+
+    //	NOTE: the program name 'the_program' in the command line below is ignored in the
+    //	the test program.
+
+    // clang-format off
+	std::vector<std::string> tokens{"the_program",
+        "--symbol", "SPY",
+        "--new-data-source", "file",
+        "--new-data-dir", "./test_files",
+        "--source-format", "csv",
+        "--mode", "load",
+        "--interval", "eod",
+        "--scale", "linear",
+        "--price-fld-name", "Close",
+        "--destination", "file",
+        "--output-chart-dir", "/tmp/test_charts_fanout/all",
+        "--boxsize", "10",
+        "--boxsize", "5",
+        "--reversal", "3",
+        "--reversal", "1",
+        "--log-path", "/tmp/PF_Collect/test26.log"
+	};
+    // clang-format on
+
+    const auto all_charts = RunAndCollectCharts(tokens);
+    ASSERT_EQ(all_charts.size(), 4);
+
+    const std::vector<std::pair<std::string, std::string>> combinations = {
+        {"10", "3"}, {"10", "1"}, {"5", "3"}, {"5", "1"}};
+
+    for (const auto &[boxsize, reversal] : combinations)
+    {
+        // clang-format off
+        std::vector<std::string> tokens1{"the_program",
+            "--symbol", "SPY",
+            "--new-data-source", "file",
+            "--new-data-dir", "./test_files",
+            "--source-format", "csv",
+            "--mode", "load",
+            "--interval", "eod",
+            "--scale", "linear",
+            "--price-fld-name", "Close",
+            "--destination", "file",
+            "--output-chart-dir", "/tmp/test_charts_fanout/one",
+            "--boxsize", boxsize,
+            "--reversal", reversal,
+            "--log-path", "/tmp/PF_Collect/test27.log"
+        };
+        // clang-format on
+
+        const auto one_chart = RunAndCollectCharts(tokens1);
+        ASSERT_EQ(one_chart.size(), 1);
+
+        const auto &[file_name, chart] = *one_chart.begin();
+        ASSERT_TRUE(all_charts.contains(file_name)) << file_name;
+        EXPECT_EQ(all_charts.at(file_name), chart) << file_name;
+    }
+}
+
 class LoadAndUpdate : public Test
 {
 };
@@ -69,6 +69,7 @@ namespace vws = std::ranges::views;
 // #include <range/v3/range/conversion.hpp>
 
 #include <decimal.hh>
+#include <json/json.h>
 
 using decimal::Decimal;
 
@@ -165,6 +166,54 @@ std::optional<int> FindColumnIndex(std::string_view header, std::string_view col
     // uni
 } // -----  end of method PF_CollectDataApp::FindColumnIndex  -----
 
+// the SPY 1 minute streaming data is used by many tests. Load and parse it once
+// into (time, price) pairs.
+
+const std::vector<std::pair<PF_Column::TmPt, Decimal>> &SPYStreamingPrices()
+{
+    static const std::vector<std::pair<PF_Column::TmPt, Decimal>> prices = [] {
+        const fs::path csv_file_name{"./test_files/SPY_streaming_1min_2022-10-07.csv"};
+        const std::string file_content_csv = LoadDataFileForUse(csv_file_name);
+
+        const auto symbol_data_records = split_string<std::string_view>(file_content_csv, "\n");
+        const auto header_record = symbol_data_records.front();
+
+        auto date_column = FindColumnIndex(header_record, "date", ",");
+        BOOST_ASSERT_MSG(date_column.has_value(),
+                         std::format("Can't find 'date' field in header record: {}.", header_record).c_str());
+
+        auto close_column = FindColumnIndex(header_record, "close", ",");
+        BOOST_ASSERT_MSG(close_column.has_value(),
+                         std::format("Can't find price field: 'Close' in header record: {}.", header_record).c_str());
+
+        std::vector<std::pair<PF_Column::TmPt, Decimal>> result;
+        for (const auto record : symbol_data_records | vws::drop(1))
+        {
+            if (record.empty())
+            {
+                continue;
+            }
+            const auto fields = split_string<std::string_view>(record, ",");
+            result.emplace_back(StringToUTCTimePoint("%F %X%z", fields[date_column.value()]),
+                                sv2dec(fields[close_column.value()]));
+        }
+        return result;
+    }();
+    return prices;
+}
+
+// compare the signals of 2 charts one by one so a failure says which signal differs
+
+void ExpectSameSignals(const PF_Chart &chart, const PF_Chart &expected)
+{
+    ASSERT_EQ(chart.GetSignals().size(), expected.GetSignals().size());
+    for (size_t i = 0; i < expected.GetSignals().size(); ++i)
+    {
+        EXPECT_EQ(chart.GetSignals()[i].signal_type_, expected.GetSignals()[i].signal_type_) << "signal: " << i;
+        EXPECT_EQ(chart.GetSignals()[i].box_, expected.GetSignals()[i].box_) << "signal: " << i;
+    }
+}
+
 class RangeSplitterBasicFunctionality : public Test
 {
 };
@@ -530,6 +579,90 @@ TEST_F(BoxesBasicFunctionality, LinearBoxesNextandPrev) // NOLINT
     EXPECT_EQ(box, 90);
 }
 
+TEST_F(BoxesBasicFunctionality, LinearBoxesFarJumpsMatchLadderWalk) // NOLINT
+{
+    // a linear box is just base + n * box_size so a far jump must land on
+    // exactly the same box as walking the ladder one price at a time. That
+    // doesn't depend on how far the jump is so keep the ladders short.
+
+    Boxes boxes{Decimal{10}};
+    Boxes::Box box = boxes.FindBox(101);
+    EXPECT_EQ(box, 101);
+
+    box = boxes.FindBox(5'005);
+    EXPECT_EQ(box, 5'001);
+
+    box = boxes.FindBox(5);
+    EXPECT_EQ(box, 1);
+
+    Boxes walked{Decimal{10}};
+    for (int32_t price = 101; price <= 5'005; price += 7)
+    {
+        walked.FindBox(price);
+    }
+    for (int32_t price = 101; price >= 5; price -= 7)
+    {
+        walked.FindBox(price);
+    }
+
+    Boxes jumped{Decimal{10}};
+    jumped.FindBox(101);
+
+    const std::vector<int32_t> prices = {5'005, 5, 2'500, 2'511, 250, 249, 111, 110, 101, 100};
+    for (auto price : prices)
+    {
+        EXPECT_EQ(jumped.FindBox(price), walked.FindBox(price)) << "price: " << price;
+    }
+    EXPECT_EQ(jumped.FindNextBox(jumped.FindBox(3'777)), 3'781);
+    EXPECT_EQ(jumped.FindPrevBox(jumped.FindBox(3'777)), 3'761);
+
+    // small fractional boxes on a high priced symbol are the intraday case
+
+    Boxes boxes2{Decimal(".01")};
+    box = boxes2.FindBox(Decimal("4500.00"));
+    EXPECT_EQ(box, Decimal("4500.00"));
+
+    box = boxes2.FindBox(Decimal("4512.37"));
+    EXPECT_EQ(box, Decimal("4512.37"));
+
+    box = boxes2.FindBox(Decimal("4487.05"));
+    EXPECT_EQ(box, Decimal("4487.05"));
+
+    box = boxes2.FindNextBox(Decimal("4512.37"));
+    ASSERT_EQ(box, Decimal("4512.38"));
+}
+
+TEST_F(BoxesBasicFunctionality, MapWholePriceSpanToLinearBoxesInOnePass) // NOLINT
+{
+    // mapping a whole price history to boxes in one pass on a fresh ladder gives the
+    // same boxes as looking up each price on a ladder already built to cover the range.
+
+    const auto prices = SPYStreamingPrices() | vws::values | rng::to<std::vector>();
+    ASSERT_FALSE(prices.empty());
+
+    Boxes fresh{Decimal(".01")};
+    const auto boxes_one_pass =
+        prices | vws::transform([&fresh](const auto &price) { return fresh.FindBox(price); }) |
+        rng::to<std::vector>();
+
+    Boxes covering{Decimal(".01")};
+    covering.FindBox(prices.front());
+    covering.FindBox(rng::min(prices));
+    covering.FindBox(rng::max(prices));
+    const auto covering_size = covering.GetBoxList().size();
+
+    std::vector<Decimal> boxes_per_price;
+    for (const auto &price : prices)
+    {
+        boxes_per_price.push_back(covering.FindBox(price));
+    }
+
+    // the lookups on the covering ladder didn't need to add any boxes
+
+    EXPECT_EQ(covering.GetBoxList().size(), covering_size);
+    ASSERT_EQ(boxes_one_pass, boxes_per_price);
+}
+
 TEST_F(BoxesBasicFunctionality, GeneratePercentBoxes) // NOLINT
 {
     // I'm not sure how du Plessis is doing his rounding (p. 492) but
@@ -587,6 +720,42 @@ TEST_F(BoxesBasicFunctionality, PercentBoxesNextandPrev) // NOLINT
     EXPECT_EQ(box, 500);
 }
 
+TEST_F(BoxesBasicFunctionality, PercentBoxesFarJumpsMatchLadderWalk) // NOLINT
+{
+    // percent boxes are rounded at each step so any shortcut to a far away box
+    // has to reproduce the step by step ladder exactly, rounding included.
+
+    Boxes walked{500, 0.01, BoxScale::e_Percent};
+    for (int32_t price = 500; price <= 900; ++price)
+    {
+        walked.FindBox(price);
+    }
+    for (int32_t price = 900; price >= 250; --price)
+    {
+        walked.FindBox(price);
+    }
+
+    Boxes jumped{500, 0.01, BoxScale::e_Percent};
+    jumped.FindBox(500);
+
+    const std::vector<int32_t> prices = {900, 250, 899, 251, 700, 532, 516, 520, 499, 333, 500};
+    for (auto price : prices)
+    {
+        const auto jumped_box = jumped.FindBox(price);
+        EXPECT_EQ(jumped_box, walked.FindBox(price)) << "price: " << price;
+        EXPECT_EQ(jumped.FindNextBox(jumped_box), walked.FindNextBox(jumped_box)) << "price: " << price;
+        EXPECT_EQ(jumped.FindPrevBox(jumped_box), walked.FindPrevBox(jumped_box)) << "price: " << price;
+    }
+
+    // and the known du Plessis values still come out the same after a far jump
+
+    Boxes boxes{500, 0.01, BoxScale::e_Percent};
+    boxes.FindBox(500);
+    boxes.FindBox(900);
+    EXPECT_EQ(boxes.FindBox(532), Decimal("530.760"));
+    ASSERT_EQ(boxes.FindBox(516), Decimal("515.150"));
+}
+
 TEST_F(BoxesBasicFunctionality, BoxesToAndFromJson) // NOLINT
 {
     const std::string data = "500.0 505.0 510.05 515.151 520.303 525.506 530.761";
@@ -639,6 +808,58 @@ TEST_F(BoxesBasicFunctionality, BoxesToJsonThenFromJsonThenAddData) // NOLINT
     ASSERT_EQ(boxes, boxes_2);
 }
 
+TEST_F(BoxesBasicFunctionality, BoxesToJsonThenFromJsonAfterFarJumps) // NOLINT
+{
+    // a ladder which spans a wide range must survive a JSON round trip and then
+    // keep producing the same boxes as the original.
+
+    Boxes linear{Decimal(".01")};
+    linear.FindBox(Decimal("4500.00"));
+    linear.FindBox(Decimal("4612.37"));
+    linear.FindBox(Decimal("4387.05"));
+
+    Boxes linear2{linear.ToJSON()};
+    EXPECT_EQ(linear, linear2);
+    EXPECT_EQ(linear.FindBox(Decimal("4700.01")), linear2.FindBox(Decimal("4700.01")));
+    EXPECT_EQ(linear, linear2);
+
+    Boxes percent{500, 0.01, BoxScale::e_Percent};
+    percent.FindBox(500);
+    percent.FindBox(900);
+    percent.FindBox(250);
+
+    Boxes percent2{percent.ToJSON()};
+    EXPECT_EQ(percent, percent2);
+    EXPECT_EQ(percent.FindBox(1200), percent2.FindBox(1200));
+    EXPECT_EQ(percent.FindBox(100), percent2.FindBox(100));
+    ASSERT_EQ(percent, percent2);
+}
+
+TEST_F(BoxesBasicFunctionality, CountPriceHitsPerBox) // NOLINT
+{
+    // a 'hit' is one price which lands in a box. This is the replay we do now for
+    // support/resistance analysis; any running count kept while the chart is
+    // built must come out the same.
+
+    const std::vector<int32_t> prices = {1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129, 1120, 1139, 1121, 1129,
+                                         1138, 1113, 1139, 1123, 1128, 1136, 1111, 1095, 1102, 1108, 1092, 1129, 1122,
+                                         1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127, 1138, 1111, 1122, 1111, 1128,
+                                         1115, 1117, 1120, 1119, 1132, 1133, 1147, 1131, 1159, 1136, 1127};
+
+    Boxes boxes{Decimal{10}};
+    std::map<Boxes::Box, int32_t> hits;
+    rng::for_each(prices, [&boxes, &hits](const auto &x) { ++hits[boxes.FindBox(x)]; });
+
+    const std::map<Boxes::Box, int32_t> expected = {{Decimal{1090}, 2},  {Decimal{1100}, 5}, {Decimal{1110}, 10},
+                                                    {Decimal{1120}, 17}, {Decimal{1130}, 14}, {Decimal{1140}, 1},
+                                                    {Decimal{1150}, 1}};
+    EXPECT_EQ(hits, expected);
+
+    // every price is counted exactly once
+
+    ASSERT_EQ(rng::fold_left(hits | vws::values, 0UZ, std::plus<>{}), prices.size());
+}
+
 class Combinatorial : public Test
 {
 };
@@ -1222,6 +1443,45 @@ TEST_F(ColumnFunctionality10X3, ProcessCompletelyFirstSetOfTestData) // NOLINT
     //    std::cout << col << '\n';
 }
 
+class ColumnFunctionalityFractionalBoxes01X3 : public Test
+{
+};
+
+TEST_F(ColumnFunctionalityFractionalBoxes01X3, IgnoredValuesLeaveColumnUnchanged) // NOLINT
+{
+    // most streamed prices neither extend nor reverse a column. Those must come
+    // back e_Ignored without changing anything about the column.
+
+    Boxes boxes{Decimal(".01")};
+    PF_Column col{&boxes, 0, 3};
+
+    int32_t ignored = 0;
+    for (const auto &[the_time, price] : SPYStreamingPrices())
+    {
+        const auto top = col.GetTop();
+        const auto bottom = col.GetBottom();
+        const auto direction = col.GetDirection();
+        const auto had_reversal = col.GetHadReversal();
+
+        auto [status, new_col] = col.AddValue(price, the_time);
+        if (status == PF_Column::Status::e_Ignored)
+        {
+            ++ignored;
+            EXPECT_EQ(col.GetTop(), top) << "price: " << price;
+            EXPECT_EQ(col.GetBottom(), bottom) << "price: " << price;
+            EXPECT_EQ(col.GetDirection(), direction) << "price: " << price;
+            EXPECT_EQ(col.GetHadReversal(), had_reversal) << "price: " << price;
+            EXPECT_FALSE(new_col.has_value());
+        }
+        else if (status == PF_Column::Status::e_Reversal)
+        {
+            col = std::move(new_col.value());
+            col.AddValue(price, the_time);
+        }
+    }
+    ASSERT_GT(ignored, 0);
+}
+
 class ColumnFunctionality10X5 : public Test
 {
 };
@@ -1675,6 +1935,55 @@ TEST_F(ChartFunctionality10X2, TestChartReverseIteratorWithFirstSetOfTestData) /
     EXPECT_EQ((chart.rbegin() += 5)->GetHadReversal(), false);
 }
 
+TEST_F(ChartFunctionality10X2, IndexAndIteratorAccessAgree) // NOLINT
+{
+    // chart[i], the iterators and copies taken from them must all describe the
+    // same columns however the chart stores them internally.
+
+    const std::vector<int32_t> values_ints_1 = {1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129,
+                                                1120, 1139, 1121, 1129, 1138, 1113, 1139, 1123, 1128,
+                                                1136, 1111, 1095, 1102, 1108, 1092, 1129};
+    const std::vector<int32_t> values_ints_2 = {1122, 1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127,
+                                                1138, 1111, 1122, 1111, 1128, 1115, 1117, 1120, 1119,
+                                                1132, 1133, 1147, 1131, 1159, 1136, 1127};
+    std::string test_data_1 = MakeSimpleTestData(
+        values_ints_1, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]});
+    std::string test_data_2 = MakeSimpleTestData(
+        values_ints_2, std::chrono::year_month_day{2016y / std::chrono::March / std::chrono::Monday[1]});
+
+    std::istringstream prices_1{test_data_1};
+
+    PF_Chart chart("GOOG", 10, 2);
+    chart.BuildChartFromCSVStream(&prices_1, "%Y-%m-%d", ",");
+    ASSERT_GT(chart.size(), 1);
+
+    int32_t col_nbr = 0;
+    for (auto it = chart.begin(); it != chart.end(); ++it, ++col_nbr)
+    {
+        EXPECT_EQ(it->GetColumnNumber(), col_nbr);
+        EXPECT_EQ(*it, chart[col_nbr]);
+        EXPECT_EQ(chart.begin()[col_nbr], chart[col_nbr]);
+        EXPECT_EQ(it->GetTop(), chart[col_nbr].GetTop());
+        EXPECT_EQ(it->GetBottom(), chart[col_nbr].GetBottom());
+        EXPECT_EQ(it->GetDirection(), chart[col_nbr].GetDirection());
+        EXPECT_EQ(it->GetColumnBoxes().size(), chart[col_nbr].GetColumnBoxes().size());
+    }
+    EXPECT_EQ(col_nbr, chart.size());
+
+    // copies of finished columns don't change when the chart keeps growing
+
+    const auto first_size = chart.size();
+    const PF_Column first_col = chart[0];
+    const PF_Column next_to_last_col = chart[first_size - 2];
+
+    std::istringstream prices_2{test_data_2};
+    chart.BuildChartFromCSVStream(&prices_2, "%Y-%m-%d", ",");
+
+    EXPECT_GT(chart.size(), first_size);
+    EXPECT_EQ(chart[0], first_col);
+    ASSERT_EQ(chart[first_size - 2], next_to_last_col);
+}
+
 TEST_F(ChartFunctionality10X2, ProcessSomeDataThenToJSONThenFromJSONThenMoreData) // NOLINT
 {
     const std::vector<int32_t> values_ints = {
@@ -1901,6 +2210,96 @@ TEST_F(MiscChartFunctionality, TestChartIterators) // NOLINT
     EXPECT_EQ(rng::distance(chart5), 1);
 }
 
+TEST_F(MiscChartFunctionality, SameResultsForEachReversalHoweverChartIsBuilt) // NOLINT
+{
+    // for every reversal count, a chart restored from JSON has to continue exactly
+    // where it left off and end up the same as one built in a single pass.
+
+    const std::vector<int32_t> values_ints_1 = {1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129,
+                                                1120, 1139, 1121, 1129, 1138, 1113, 1139, 1123, 1128,
+                                                1136, 1111, 1095, 1102, 1108, 1092, 1129};
+    const std::vector<int32_t> values_ints_2 = {1122, 1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127,
+                                                1138, 1111, 1122, 1111, 1128, 1115, 1117, 1120, 1119,
+                                                1132, 1133, 1147, 1131, 1159, 1136, 1127};
+    std::string test_data_1 = MakeSimpleTestData(
+        values_ints_1, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]});
+    std::string test_data_2 = MakeSimpleTestData(
+        values_ints_2, std::chrono::year_month_day{2016y / std::chrono::March / std::chrono::Monday[1]});
+
+    // known column counts from the ColumnFunctionality10X1/X2/X3/X5 tests. 4 and 7 cover
+    // reversals outside 1/2/3/5.
+
+    const std::map<int32_t, size_t> known_sizes = {{1, 9}, {2, 6}, {3, 3}, {5, 1}};
+
+    for (int32_t reversal : {1, 2, 3, 4, 5, 7})
+    {
+        std::istringstream prices_1{test_data_1};
+        std::istringstream prices_2{test_data_2};
+
+        PF_Chart whole_chart("GOOG", 10, reversal);
+        whole_chart.BuildChartFromCSVStream(&prices_1, "%Y-%m-%d", ",");
+        whole_chart.BuildChartFromCSVStream(&prices_2, "%Y-%m-%d", ",");
+
+        if (known_sizes.contains(reversal))
+        {
+            EXPECT_EQ(whole_chart.size(), known_sizes.at(reversal)) << "reversal: " << reversal;
+        }
+
+        prices_1.clear();
+        prices_1.seekg(0);
+        prices_2.clear();
+        prices_2.seekg(0);
+
+        PF_Chart half_chart("GOOG", 10, reversal);
+        half_chart.BuildChartFromCSVStream(&prices_1, "%Y-%m-%d", ",");
+
+        PF_Chart restored_chart{half_chart.ToJSON()};
+        restored_chart.BuildChartFromCSVStream(&prices_2, "%Y-%m-%d", ",");
+
+        EXPECT_EQ(whole_chart, restored_chart) << "reversal: " << reversal;
+    }
+
+    // same again with intraday data on both linear and percent boxes, restoring
+    // at more than one point along the way.
+
+    const auto &prices = SPYStreamingPrices();
+
+    auto make_chart = [](int32_t reversal, BoxScale scale) {
+        return scale == BoxScale::e_Linear ? PF_Chart{"SPY", Decimal(".01"), reversal}
+                                           : PF_Chart{"SPY", Decimal(".01"), reversal, Decimal(".001"), scale};
+    };
+
+    for (const auto scale : {BoxScale::e_Linear, BoxScale::e_Percent})
+    {
+        for (int32_t reversal : {1, 2, 3, 4, 5, 7})
+        {
+            PF_Chart whole_chart = make_chart(reversal, scale);
+            for (const auto &[the_time, price] : prices)
+            {
+                whole_chart.AddValue(price, the_time);
+            }
+
+            for (const size_t pieces : {2UZ, 3UZ, 8UZ})
+            {
+                const auto piece_size = (prices.size() + pieces - 1) / pieces;
+
+                PF_Chart restored_chart = make_chart(reversal, scale);
+                for (const auto piece : prices | vws::chunk(piece_size))
+                {
+                    PF_Chart next_chart{restored_chart.ToJSON()};
+                    for (const auto &[the_time, price] : piece)
+                    {
+                        next_chart.AddValue(price, the_time);
+                    }
+                    restored_chart = next_chart;
+                }
+                EXPECT_EQ(whole_chart, restored_chart) << "scale: " << std::to_underlying(scale)
+                                                       << " reversal: " << reversal << " pieces: " << pieces;
+            }
+        }
+    }
+}
+
 TEST_F(MiscChartFunctionality, TestChartBoxFiltersWithBoxes) // NOLINT
 {
     const std::string data =
@@ -1968,6 +2367,40 @@ TEST_F(MiscChartFunctionality, TestChartBoxFiltersWithColumns) // NOLINT
     EXPECT_EQ(chart5.GetTopBottomForColumns(PF_ColumnFilter::e_up_column).size(), 1);
     EXPECT_EQ(chart5.GetTopBottomForColumns(PF_ColumnFilter::e_reversed_to_down).size(), 0);
 }
+
+TEST_F(MiscChartFunctionality, ColumnFiltersAgreeWhileChartGrows) // NOLINT
+{
+    // at several points while the chart grows, each column filter query gives the
+    // same result as it does on a copy of the chart loaded from its JSON.
+
+    const auto &prices = SPYStreamingPrices();
+
+    const std::vector<PF_ColumnFilter> filters = {PF_ColumnFilter::e_up_column, PF_ColumnFilter::e_down_column,
+                                                  PF_ColumnFilter::e_reversed_to_up,
+                                                  PF_ColumnFilter::e_reversed_to_down};
+
+    PF_Chart chart{"SPY", Decimal(".01"), 1};
+
+    const auto every = std::max(prices.size() / 10, 1UZ);
+    for (size_t i = 0; i < prices.size(); ++i)
+    {
+        chart.AddValue(prices[i].second, prices[i].first);
+
+        if ((i + 1) % every != 0 && i + 1 != prices.size())
+        {
+            continue;
+        }
+        const PF_Chart loaded_chart{chart.ToJSON()};
+        for (const auto filter : filters)
+        {
+            EXPECT_EQ(chart.GetBoxesForColumns(filter), loaded_chart.GetBoxesForColumns(filter))
+                << "after: " << i + 1 << " filter: " << std::to_underlying(filter);
+            EXPECT_EQ(chart.GetTopBottomForColumns(filter), loaded_chart.GetTopBottomForColumns(filter))
+                << "after: " << i + 1 << " filter: " << std::to_underlying(filter);
+        }
+    }
+}
+
 TEST_F(MiscChartFunctionality, LoadDataFromJSONChartFileThenAddDataFromCSV) // NOLINT
 {
     fs::path symbol_file_name{"./test_files/SPY_1.json"};
@@ -2011,6 +2444,75 @@ TEST_F(MiscChartFunctionality, LoadDataFromJSONChartFileWithMissingValues)
 
     std::cout << new_chart << '\n';
 }
+
+TEST_F(MiscChartFunctionality, WriteChartJSONToStreamThenLoadThenWriteIsByteForByte) // NOLINT
+{
+    // chart files are written straight from the chart. Whatever does the writing,
+    // the text must parse to the same JSON as ToJSON() and load back into a chart
+    // which writes exactly the same bytes again.
+
+    auto check_round_trip = [](const PF_Chart &chart, const fs::path &chart_file_name) {
+        std::ostringstream chart_text;
+        chart.ConvertChartToJsonAndWriteToStream(chart_text);
+
+        Json::Value parsed;
+        Json::CharReaderBuilder builder;
+        std::string errors;
+        std::istringstream chart_text_in{chart_text.str()};
+        ASSERT_TRUE(Json::parseFromStream(builder, chart_text_in, &parsed, &errors)) << errors;
+        EXPECT_EQ(parsed, chart.ToJSON());
+
+        {
+            std::ofstream chart_file{chart_file_name, std::ios::out | std::ios::binary | std::ios::trunc};
+            chart_file << chart_text.str();
+        }
+        PF_Chart chart2;
+        PF_Chart::LoadChartFromJSONPF_ChartFile(chart2, chart_file_name);
+        EXPECT_EQ(chart, chart2);
+
+        std::ostringstream chart2_text;
+        chart2.ConvertChartToJsonAndWriteToStream(chart2_text);
+        ASSERT_EQ(chart_text.str(), chart2_text.str());
+    };
+
+    const fs::path file_name{"./test_files/AAPL_close.dat"};
+
+    std::ifstream prices{file_name};
+
+    PF_Chart chart("AAPL", 2, 2);
+    chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+    check_round_trip(chart, "/tmp/AAPL_2X2_round_trip.json");
+
+    // and a chart with signals and intraday column times
+
+    PF_Chart spy_chart{"SPY", Decimal(".01"), 3};
+    for (const auto &[the_time, price] : SPYStreamingPrices())
+    {
+        spy_chart.AddValue(price, the_time);
+    }
+    EXPECT_FALSE(spy_chart.GetSignals().empty());
+
+    check_round_trip(spy_chart, "/tmp/SPY_01X3_round_trip.json");
+}
+
+TEST_F(MiscChartFunctionality, LoadStoredJSONChartFileThenRoundTripJSON) // NOLINT
+{
+    // chart files written before any change to the boxes encoding must still load
+    // and then come back unchanged from whatever ToJSON writes now.
+
+    fs::path symbol_file_name{"./test_files/SPY_1.json"};
+
+    PF_Chart stored_chart;
+    PF_Chart::LoadChartFromJSONPF_ChartFile(stored_chart, symbol_file_name);
+
+    PF_Chart chart2{stored_chart.ToJSON()};
+    EXPECT_EQ(stored_chart, chart2);
+
+    chart2.AddValue("500", "2030-01-02", "%Y-%m-%d");
+    stored_chart.AddValue("500", "2030-01-02", "%Y-%m-%d");
+    ASSERT_EQ(stored_chart, chart2);
+}
 TEST_F(MiscChartFunctionality, LoadDataFromCSVFileThenAddDataFromPricesDB) // NOLINT
 {
     if (fs::exists("/tmp/candlestick5.svg"))
@@ -2149,6 +2651,34 @@ TEST_F(MiscChartFunctionality, LoadDataFromCSVFileThenMakeChartThenExportCSV) //
     ASSERT_TRUE(fs::exists("/tmp/SPY_chart.csv"));
 }
 
+TEST_F(MiscChartFunctionality, ExportTableIsDeterministicAndSurvivesJSONRoundTrip) // NOLINT
+{
+    // this does not check what is in the table, only that writing it is repeatable
+    // and that a chart loaded back from its JSON exports exactly the same table.
+
+    const fs::path file_name{"./test_files/AAPL_close.dat"};
+
+    std::ifstream prices{file_name};
+
+    PF_Chart chart("AAPL", 2, 2);
+    chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+    std::ostringstream table_text;
+    chart.ConvertChartToTableAndWriteToStream(table_text);
+    ASSERT_FALSE(table_text.str().empty());
+
+    std::ostringstream table_text_again;
+    chart.ConvertChartToTableAndWriteToStream(table_text_again);
+    EXPECT_EQ(table_text.str(), table_text_again.str());
+
+    PF_Chart chart2{chart.ToJSON()};
+    ASSERT_EQ(chart, chart2);
+
+    std::ostringstream table2_text;
+    chart2.ConvertChartToTableAndWriteToStream(table2_text);
+    ASSERT_EQ(table_text.str(), table2_text.str());
+}
+
 TEST_F(MiscChartFunctionality, DontReloadOldData) // NOLINT
 {
     const std::string data =
@@ -2214,6 +2744,207 @@ TEST_F(MiscChartFunctionality, DontReloadOldDataButCanAddNewData) // NOLINT
     ASSERT_NE(chart, saved_chart);
 }
 
+TEST_F(MiscChartFunctionality, OverlappingDataOnlyAddsNewerRecords) // NOLINT
+{
+    // feeding a chart a stream which starts with data it has already seen must give
+    // the same chart as building it from that stream all at once -- whether the old
+    // records are skipped one at a time or by seeking past them.
+
+    const std::vector<int32_t> values_ints = {
+        1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129, 1120, 1139, 1121, 1129, 1138, 1113, 1139, 1123,
+        1128, 1136, 1111, 1095, 1102, 1108, 1092, 1129, 1122, 1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127,
+        1138, 1111, 1122, 1111, 1128, 1115, 1117, 1120, 1119, 1132, 1133, 1147, 1131, 1159, 1136, 1127};
+    const auto first_day = std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]};
+
+    std::string test_data = MakeSimpleTestData(values_ints, first_day);
+    std::istringstream prices{test_data};
+
+    PF_Chart whole_chart("GOOG", 10, 2);
+    whole_chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+    // the same full data as a seekable file
+
+    const fs::path file_name{"/tmp/overlapping_prices.csv"};
+    {
+        std::ofstream out{file_name, std::ios::out | std::ios::trunc};
+        out << test_data;
+    }
+
+    // stop part way through. The full stream fed next then has a record dated exactly
+    // at the chart's last entry, followed by newer ones.
+
+    for (auto how_many : {1UZ, 20UZ, 25UZ, 49UZ, 50UZ})
+    {
+        std::string test_data_1 =
+            MakeSimpleTestData(values_ints | vws::take(how_many) | rng::to<std::vector>(), first_day);
+        std::istringstream prices_1{test_data_1};
+
+        PF_Chart chart("GOOG", 10, 2);
+        chart.BuildChartFromCSVStream(&prices_1, "%Y-%m-%d", ",");
+
+        PF_Chart chart_from_file = chart;
+
+        std::istringstream prices_2{test_data};
+        chart.BuildChartFromCSVStream(&prices_2, "%Y-%m-%d", ",");
+        EXPECT_EQ(chart, whole_chart) << "stopped after: " << how_many;
+
+        // and the same thing from the seekable file
+
+        std::ifstream prices_3{file_name};
+        chart_from_file.BuildChartFromCSVStream(&prices_3, "%Y-%m-%d", ",");
+        EXPECT_EQ(chart_from_file, whole_chart) << "stopped after: " << how_many;
+    }
+}
+
+TEST_F(MiscChartFunctionality, IgnoredValuesDontChangeChartContent) // NOLINT
+{
+    // an update which brings only ignored values leaves the columns and signals
+    // alone, so there is nothing new to store or draw for that chart.
+
+    const std::vector<int32_t> values_ints = {
+        1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129, 1120, 1139, 1121, 1129, 1138, 1113, 1139, 1123,
+        1128, 1136, 1111, 1095, 1102, 1108, 1092, 1129, 1122, 1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127,
+        1138, 1111, 1122, 1111, 1128, 1115, 1117, 1120, 1119, 1132, 1133, 1147, 1131, 1159, 1136, 1127};
+
+    std::string test_data = MakeSimpleTestData(
+        values_ints, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]});
+    std::istringstream prices{test_data};
+
+    PF_Chart chart("GOOG", 10, 2);
+    chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+    auto chart_content = [](const PF_Chart &a_chart) {
+        auto columns = a_chart | vws::transform([](const auto &col) {
+                           return std::tuple{col.GetTop(), col.GetBottom(), col.GetDirection(), col.GetHadReversal()};
+                       }) |
+                       rng::to<std::vector>();
+        return std::pair{columns, a_chart.GetSignals().size()};
+    };
+
+    const auto saved_content = chart_content(chart);
+
+    // the last column is down from 1140 to 1130 so these all stay in its bottom box
+
+    const std::vector<int32_t> values_ints_2 = {1131, 1139, 1135, 1130, 1138};
+    std::string test_data_2 = MakeSimpleTestData(
+        values_ints_2, std::chrono::year_month_day{2016y / std::chrono::March / std::chrono::Monday[1]});
+
+    auto data_values = rng_split_string<std::string_view>(test_data_2, "\n");
+    for (const auto &record : data_values)
+    {
+        if (record.empty())
+        {
+            continue;
+        }
+        const auto fields = split_string<std::string_view>(record, ",");
+        auto status = chart.AddValue(sv2dec(fields[1]), StringToUTCTimePoint("%Y-%m-%d", fields[0]));
+        EXPECT_EQ(status, PF_Column::Status::e_Ignored) << "value: " << fields[1];
+    }
+    EXPECT_EQ(chart_content(chart), saved_content);
+
+    // and something that does change a box is seen
+
+    chart.AddValue("1120", "2017-03-01", "%Y-%m-%d");
+    ASSERT_NE(chart_content(chart), saved_content);
+}
+
+TEST_F(MiscChartFunctionality, SnapshotsDontSeeLaterValues) // NOLINT
+{
+    // a snapshot of a streaming chart, taken for drawing or dumping, must show the
+    // chart exactly as it was when taken no matter what the processor adds after.
+
+    const auto &prices = SPYStreamingPrices();
+
+    PF_Chart chart{"SPY", Decimal(".01"), 1};
+
+    std::vector<std::pair<size_t, PF_Chart>> snapshots;
+    const auto every = std::max(prices.size() / 7, 1UZ);
+    for (size_t i = 0; i < prices.size(); ++i)
+    {
+        chart.AddValue(prices[i].second, prices[i].first);
+        if ((i + 1) % every == 0)
+        {
+            snapshots.emplace_back(i + 1, chart);
+        }
+    }
+    ASSERT_FALSE(snapshots.empty());
+
+    for (const auto &[how_many, snapshot] : snapshots)
+    {
+        PF_Chart expected{"SPY", Decimal(".01"), 1};
+        for (const auto &[the_time, price] : prices | vws::take(how_many))
+        {
+            expected.AddValue(price, the_time);
+        }
+
+        EXPECT_EQ(snapshot, expected) << "snapshot after: " << how_many;
+        EXPECT_EQ(snapshot.size(), expected.size()) << "snapshot after: " << how_many;
+    }
+}
+
+TEST_F(MiscChartFunctionality, GraphicColumnLimitDoesntChangeColumnsOrSignals) // NOLINT
+{
+    // a long streaming session only ever draws the most recent columns but older
+    // columns still matter to the signal logic. Limiting how many columns are kept
+    // for graphics must not change the columns or signals found.
+
+    PF_Chart chart{"SPY", Decimal(".01"), 1};
+    PF_Chart limited_chart{"SPY", Decimal(".01"), 1, 0, BoxScale::e_Linear, 30};
+
+    for (const auto &[the_time, price] : SPYStreamingPrices())
+    {
+        EXPECT_EQ(chart.AddValue(price, the_time), limited_chart.AddValue(price, the_time));
+    }
+
+    // make sure we went well past the limit
+
+    EXPECT_GT(chart.size(), 30);
+    ASSERT_EQ(limited_chart.size(), chart.size());
+
+    for (size_t i = 0; i < chart.size(); ++i)
+    {
+        EXPECT_EQ(limited_chart[i].GetTop(), chart[i].GetTop()) << "column: " << i;
+        EXPECT_EQ(limited_chart[i].GetBottom(), chart[i].GetBottom()) << "column: " << i;
+        EXPECT_EQ(limited_chart[i].GetDirection(), chart[i].GetDirection()) << "column: " << i;
+        EXPECT_EQ(limited_chart[i].GetHadReversal(), chart[i].GetHadReversal()) << "column: " << i;
+    }
+
+    ExpectSameSignals(limited_chart, chart);
+}
+
+TEST_F(MiscChartFunctionality, SignalsOnlyAddedWhenValueReportsSignal) // NOLINT
+{
+    // streaming code watches the status returned from AddValue to know when to
+    // look at the signals. Signals must never be dropped and a new one may only
+    // show up on a value which says it produced one.
+
+    PF_Chart chart{"SPY", Decimal(".01"), 3};
+
+    for (const auto &[the_time, price] : SPYStreamingPrices())
+    {
+        const auto signals_before = chart.GetSignals().size();
+
+        const auto status = chart.AddValue(price, the_time);
+
+        ASSERT_GE(chart.GetSignals().size(), signals_before) << "price: " << price;
+        if (chart.GetSignals().size() > signals_before)
+        {
+            EXPECT_EQ(status, PF_Column::Status::e_AcceptedWithSignal) << "price: " << price;
+        }
+        if (status == PF_Column::Status::e_AcceptedWithSignal)
+        {
+            EXPECT_GT(chart.GetSignals().size(), signals_before) << "price: " << price;
+        }
+    }
+
+    EXPECT_FALSE(chart.GetSignals().empty());
+
+    // and signals found along the way are the ones a loaded chart has
+
+    const PF_Chart chart2{chart.ToJSON()};
+    ExpectSameSignals(chart2, chart);
+}
+
 TEST_F(MiscChartFunctionality, CheckColumnBoxCounts) // NOLINT
 {
     const std::string data =
@@ -2251,6 +2982,109 @@ TEST_F(MiscChartFunctionality, CheckColumnBoxCounts) // NOLINT
     rng::for_each(chart5, [&found_lens5](const auto &col) { found_lens5.push_back(col.GetColumnBoxes().size()); });
     EXPECT_EQ(col_lens5, found_lens5);
 }
+
+TEST_F(MiscChartFunctionality, CheckColumnBoxContents) // NOLINT
+{
+    // the boxes of a column are exactly the ladder from its bottom to its top,
+    // one box size apart, so they can be derived from the column and the chart's
+    // boxes rather than stored.
+
+    const std::string data =
+        "1100 1105 1110 1112 1118 1120 1136 1121 1129 1120 1139 1121 1129 1138 1113 1139 1123 1128 1136 1111 1095 1102 "
+        "1108 1092 1129 "
+        "1122 1133 1125 1139 1105 1132 1122 1131 1127 1138 1111 1122 1111 1128 1115 1117 1120 1119 1132 1133 1147 1131 "
+        "1159 1136 1127";
+
+    std::string test_data =
+        MakeSimpleTestData(data, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]}, " ");
+
+    std::istringstream prices{test_data};
+
+    PF_Chart chart1("GOOG", 10, 1);
+    chart1.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+    auto first_boxes = chart1[0].GetColumnBoxes() | rng::to<std::vector>();
+    rng::sort(first_boxes);
+    EXPECT_EQ(first_boxes, (std::vector<Decimal>{1100, 1110, 1120, 1130}));
+
+    for (const auto &col : chart1)
+    {
+        auto col_boxes = col.GetColumnBoxes() | rng::to<std::vector>();
+        rng::sort(col_boxes);
+        ASSERT_FALSE(col_boxes.empty());
+        EXPECT_EQ(col_boxes.front(), col.GetBottom()) << "column: " << col.GetColumnNumber();
+        EXPECT_EQ(col_boxes.back(), col.GetTop()) << "column: " << col.GetColumnNumber();
+        EXPECT_TRUE(rng::all_of(col_boxes | vws::pairwise_transform(
+                                                [](const auto &a, const auto &b) { return b - a; }),
+                                [](const auto &step) { return step == 10; }))
+            << "column: " << col.GetColumnNumber();
+    }
+}
+
+TEST_F(MiscChartFunctionality, ChartsWithSameBoxParamsDontShareBoxChanges) // NOLINT
+{
+    // a chart's JSON is unchanged after another chart with the same parameters
+    // extends over a wider range, and after a copy of it adds values outside its range.
+
+    const std::vector<int32_t> values_ints = {
+        1100, 1105, 1110, 1112, 1118, 1120, 1136, 1121, 1129, 1120, 1139, 1121, 1129, 1138, 1113, 1139, 1123,
+        1128, 1136, 1111, 1095, 1102, 1108, 1092, 1129, 1122, 1133, 1125, 1139, 1105, 1132, 1122, 1131, 1127,
+        1138, 1111, 1122, 1111, 1128, 1115, 1117, 1120, 1119, 1132, 1133, 1147, 1131, 1159, 1136, 1127};
+
+    std::string test_data_a = MakeSimpleTestData(
+        values_ints, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]});
+    std::istringstream prices_a{test_data_a};
+
+    PF_Chart chart_a("GOOG", 10, 2);
+    chart_a.BuildChartFromCSVStream(&prices_a, "%Y-%m-%d", ",");
+    const auto chart_a_json = chart_a.ToJSON();
+
+    // same parameters, different symbol and a much wider price range
+
+    const auto values_ints_b =
+        values_ints | vws::transform([](auto x) { return 3 * x - 2000; }) | rng::to<std::vector>();
+    std::string test_data_b = MakeSimpleTestData(
+        values_ints_b, std::chrono::year_month_day{2015y / std::chrono::March / std::chrono::Monday[1]});
+    std::istringstream prices_b{test_data_b};
+
+    PF_Chart chart_b("AAPL", 10, 2);
+    chart_b.BuildChartFromCSVStream(&prices_b, "%Y-%m-%d", ",");
+
+    EXPECT_EQ(chart_a.ToJSON(), chart_a_json);
+    EXPECT_EQ(chart_a, PF_Chart{chart_a_json});
+
+    // a copy which goes on to extend the ladder must leave the original alone
+
+    PF_Chart chart_c = chart_a;
+    chart_c.AddValue("2500", "2016-06-01", "%Y-%m-%d");
+    chart_c.AddValue("500", "2016-06-02", "%Y-%m-%d");
+
+    EXPECT_NE(chart_c, chart_a);
+    ASSERT_EQ(chart_a.ToJSON(), chart_a_json);
+}
+
+TEST_F(MiscChartFunctionality, ColumnTopsAndBottomsStayOnBoxGrid) // NOLINT
+{
+    // on a linear chart with .01 boxes every column top and bottom is a whole
+    // number of boxes away from the bottom of the first column.
+
+    const Decimal box_size{".01"};
+    PF_Chart chart{"SPY", box_size, 3};
+
+    for (const auto &[the_time, price] : SPYStreamingPrices())
+    {
+        chart.AddValue(price, the_time);
+    }
+
+    ASSERT_GT(chart.size(), 1);
+
+    const auto origin = chart[0].GetBottom();
+    for (const auto &col : chart)
+    {
+        EXPECT_TRUE(((col.GetTop() - origin) / box_size).isinteger()) << "column: " << col.GetColumnNumber();
+        EXPECT_TRUE(((col.GetBottom() - origin) / box_size).isinteger()) << "column: " << col.GetColumnNumber();
+    }
+}
 // use ATR computed box size instead of predefined box size with logarithmic charts
 
 // class ColumnFunctionalityLogX1 : public Test
@@ -2530,6 +3364,49 @@ TEST_F(TestChartDBFunctions, ProcessFileWithFractionalDataStoreInDBThenRetrieveI
     //    std::cout << chart << '\n';
 }
 
+TEST_F(TestChartDBFunctions, StoreInDBThenUpdateAndStoreAgainSeveralTimesThenRetrieve) // NOLINT
+{
+    // daily updates usually change only the last column or add one. However much
+    // of the chart each store actually writes, what comes back must be the whole,
+    // current chart.
+
+    const fs::path file_name{"./test_files/AAPL_close.dat"};
+    const std::string file_content = LoadDataFileForUse(file_name);
+    const auto records = split_string<std::string_view>(file_content, "\n") |
+                         vws::filter([](const auto record) { return !record.empty(); }) | rng::to<std::vector>();
+
+    PF_DB::DB_Params db_params{.user_name_ = "data_updater_pg", .db_name_ = "finance", .PF_db_mode_ = "test"};
+    PF_DB pf_db{db_params};
+
+    PF_Chart chart("AAPL", 2, 2);
+
+    // store after the first half and then after each small batch of the rest
+
+    const auto first_batch = records.size() / 2;
+    constexpr size_t batch_size = 5;
+
+    for (size_t start = 0; start < records.size();)
+    {
+        const auto how_many = start == 0 ? first_batch : batch_size;
+        std::string batch;
+        for (const auto record : records | vws::drop(start) | vws::take(how_many))
+        {
+            batch.append(record).append("\n");
+        }
+        start += how_many;
+
+        std::istringstream prices{batch};
+        chart.BuildChartFromCSVStream(&prices, "%Y-%m-%d", ",");
+
+        pf_db.StorePFChartDataIntoDB(chart, "eod", {});
+
+        PF_Chart chart2 = PF_Chart::LoadChartFromChartsDB(pf_db, chart.GetChartParams(), "eod");
+        EXPECT_EQ(chart, chart2) << "after storing through record: " << start;
+    }
+
+    ASSERT_EQ(CountRows(), 1);
+}
+
 TEST_F(TestChartDBFunctions, ComputeATRUsingDataFromDB) // NOLINT
 {
     // we should get the same result as we do from tiingo, I expect